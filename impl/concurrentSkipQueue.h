@@ -0,0 +1,89 @@
+#pragma once
+
+#include "skipList.h"
+#include <mutex>
+#include <vector>
+
+namespace list {
+
+/**
+ * Implementation of the Concurrent Skip Queue class.
+ *
+ * Concurrent Skip Queue is priority queue built on Skip List, where the
+ * lowest key value is popped first. Any number of producers and consumers can
+ * use the queue at the same time. Popping from the front of Skip List needs no
+ * search, so the lock is held only for O(level of Node) steps, which makes
+ * the queue usable as timer or scheduler queue ordered by deadline.
+ *
+ * @tparam V type of data stored in Concurrent Skip Queue
+ * @tparam P key policy, CountedKeys keeps entries with equal key values
+ */
+template <typename V, KeyPolicy P = CountedKeys> class ConcurrentSkipQueue {
+private:
+  mutable std::mutex mutex; ///< guards list
+  SkipList<V, P> list;      ///< Skip List holding queued key values
+
+public:
+  /// Constructor of Concurrent Skip Queue, queue is empty
+  ConcurrentSkipQueue() = default;
+
+  /// Disabling construction of Concurrent Skip Queue using copy constructor
+  ConcurrentSkipQueue(const ConcurrentSkipQueue &rhs) = delete;
+
+  /// Disabling construction of Concurrent Skip Queue using copy assignment
+  ConcurrentSkipQueue &operator=(const ConcurrentSkipQueue &rhs) = delete;
+
+  /**
+   * Adds key value to the queue
+   *
+   * @tparam V newValue key value of Node
+   *
+   * @return result of insertNode of Skip List
+   */
+  bool push(AllComparison auto newValue) {
+    std::lock_guard lock(mutex);
+    return list.insertNode(newValue);
+  }
+
+  /**
+   * Pops the lowest key value from the queue
+   *
+   * @param value set to popped key value, unchanged if queue is empty
+   *
+   * @return true if key value is popped, false if queue is empty
+   */
+  bool tryPopFront(V &value) {
+    std::lock_guard lock(mutex);
+    if (list.empty())
+      return false;
+    value = list.front();
+    return list.popFront();
+  }
+
+  /**
+   * Pops all key values smaller than value, e.g. all expired deadlines
+   *
+   * @tparam V value key value of Node, first key value that is kept
+   *
+   * @return popped key values, from the lowest to the highest
+   */
+  std::vector<V> popFrontUntil(AllComparison auto value) {
+    std::vector<V> popped;
+    std::lock_guard lock(mutex);
+    list.popFrontUntil(value,
+                       [&popped](const V &key) { popped.push_back(key); });
+    return popped;
+  }
+
+  /**
+   * Checks if queue is empty
+   *
+   * @return true if queue holds no key values
+   */
+  bool empty() const {
+    std::lock_guard lock(mutex);
+    return list.empty();
+  }
+};
+
+} // namespace list
@@ -0,0 +1,693 @@
+#pragma once
+
+#include "skipList.h"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace list {
+
+/**
+ * Implementation of the Deterministic Skip List class.
+ *
+ * Deterministic Skip List is 1-2-3 skip list, following J. I. Munro, T.
+ * Papadakis and R. Sedgewick's paper "Deterministic Skip Lists". Node levels
+ * are not random, instead between any two consecutive Nodes on level i+1
+ * there are always 1, 2 or 3 Nodes on level i. Insert promotes the middle Node
+ * of a gap that grows to 4 Nodes, erase demotes a Node when a gap drops to 0
+ * Nodes. Search, insert and erase are O(logn) in the worst case, not only in
+ * the expected case, which bounds the latency of every operation. Public
+ * functions are the same as in SkipList class, except lookupMany.
+ *
+ * @tparam V type of data stored in Deterministic Skip List
+ * @tparam P key policy, UniqueKeys rejects duplicates, CountedKeys counts them
+ */
+template <typename V, KeyPolicy P = UniqueKeys> class DeterministicSkipList {
+private:
+  /// true if Nodes keep number of duplicates, set by CountedKeys policy
+  static constexpr bool counted = std::same_as<P, CountedKeys>;
+
+  /// Placeholder for count of Node with UniqueKeys policy, takes no space
+  struct NoCount {};
+
+  /**
+   * Implementation of the Node structure.
+   *
+   * Each Node carries a key and a forward vector carrying pointers to
+   * nodes of a different level. Forward vector grows on promotion and shrinks
+   * on demotion of Node.
+   *
+   * @tparam T data type of key in Node
+   */
+  template <typename T> struct Node {
+    T value; ///< key value of Node
+    [[no_unique_address]] std::conditional_t<counted, std::size_t, NoCount>
+        count{}; ///< number of duplicates, kept only with CountedKeys policy
+    std::vector<Node<T> *>
+        forward{}; ///< forward vector carrying pointers to nodes, with same
+    ///< values, but on a different levels
+
+    /**
+     * Node constructor.
+     *
+     * @tparam T data type of key in Node
+     * @param level level size of Node
+     */
+    explicit Node(T v, int level) : value(v), forward(level, nullptr) {
+      if constexpr (counted)
+        count = 1;
+    }
+  };
+
+  /**
+   * Max Level that Node can reach. With at least 2 Nodes below each Node
+   * of the next level, 32 levels are enough for up to 2^32 elements.
+   */
+  static constexpr int maxLevel = 32;
+
+  /// Max number of Nodes on level i between two consecutive Nodes on level i+1
+  static constexpr int maxGap = 3;
+
+  int height = 0; ///< number of levels holding at least one Node
+
+  /**
+   * Special Node that handles empty list and also configures low edge.
+   * Head Node value is set to smallest possible value of data type of Node.
+   */
+  Node<V> *head = nullptr;
+
+  /**
+   * Special Node that handles empty list and also configures high edge
+   * Nil node is set to highest possible value of data type of Node.
+   */
+  Node<V> *nil = nullptr;
+
+  /**
+   * Fetches predecessors of key value on all levels
+   *
+   * @tparam V value key value of Node
+   * @param tempNodeLevels filled with last Node before value on each level,
+   * head on levels above height
+   *
+   * @return first Node with key value not smaller than value, or nil
+   */
+  Node<V> *findNode(const V &value,
+                    std::vector<Node<V> *> &tempNodeLevels) const;
+
+  /**
+   * Search first Node with key value not smaller than value, without
+   * fetching predecessors
+   *
+   * @tparam V value key value of Node
+   *
+   * @return first Node with key value not smaller than value, or nil
+   */
+  Node<V> *lowerBound(const V &value) const;
+
+  /**
+   * Number of duplicates kept in Node
+   *
+   * @param node Node of Deterministic Skip List
+   *
+   * @return count of Node with CountedKeys policy, 1 with UniqueKeys policy
+   */
+  static std::size_t nodeCount(const Node<V> *node) {
+    if constexpr (counted)
+      return node->count;
+    else
+      return 1;
+  }
+
+  /**
+   * Removes one duplicate from Node, if Node carries more than one
+   *
+   * @param node Node of Deterministic Skip List
+   *
+   * @return true if count of Node is decremented, false if Node carries one
+   * duplicate and has to be removed
+   */
+  static bool decrementCount(Node<V> *node) {
+    if constexpr (counted) {
+      if (node->count > 1) {
+        node->count--;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Removes found Node with all its duplicates
+   *
+   * Node of a higher level takes key value of its predecessor, which always
+   * has level 1, and the predecessor is removed instead.
+   *
+   * @param node Node to be removed
+   * @param tempNodeLevels predecessors of node on all levels
+   */
+  void eraseFoundNode(Node<V> *node, std::vector<Node<V> *> &tempNodeLevels);
+
+  /**
+   * Number of Nodes in the gap after node on level
+   *
+   * @param node Node reaching level + 1
+   * @param level level of counted Nodes
+   *
+   * @return number of Nodes on level between node and its successor on
+   * level + 1
+   */
+  int gapSize(Node<V> *node, int level) const;
+
+  /**
+   * Promotes second Node of the gap after node on level to level + 1
+   *
+   * @param node Node reaching level + 1, start of the gap
+   * @param level level of the gap
+   */
+  void promote(Node<V> *node, int level);
+
+  /**
+   * Removes Node of level 1 and restores gap sizes, demoting and promoting
+   * Nodes from level 0 upwards
+   *
+   * @param node Node of level 1 to be removed
+   * @param tempNodeLevels predecessors of node on all levels
+   */
+  void removeBottomNode(Node<V> *node,
+                        const std::vector<Node<V> *> &tempNodeLevels);
+
+  /**
+   * Prints value of Node if HasToStringFunction concept is satisfied
+   *
+   * @tparam value value of key in Node
+   */
+  void outputFunction(HasToStringFunction auto value) {
+    std::cout << value.to_string() << std::endl;
+  };
+
+  /**
+   * Prints value of Node if IsStringable concept is satisfied
+   *
+   * @tparam value value of key in Node
+   */
+  void outputFunction(IsStringable auto value) {
+    std::cout << std::to_string(value) << std::endl;
+  };
+
+public:
+  /**
+   * Forward iterator over Deterministic Skip List values.
+   *
+   * Iterator walks level 0, from the lowest to the highest key value.
+   * Iterators are invalidated by erase and pop functions. Each Node is visited
+   * once, so with CountedKeys policy duplicates of key value are visited once
+   * as well.
+   */
+  class ConstIterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = V;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const V *;
+    using reference = const V &;
+
+    ConstIterator() = default;
+
+    /**
+     * Iterator constructor.
+     *
+     * @param node Node of Deterministic Skip List that iterator points to
+     */
+    explicit ConstIterator(const Node<V> *node) : node(node) {}
+
+    const V &operator*() const { return node->value; }
+    const V *operator->() const { return &node->value; }
+
+    ConstIterator &operator++() {
+      node = node->forward.at(0);
+      return *this;
+    }
+
+    ConstIterator operator++(int) {
+      ConstIterator previous = *this;
+      node = node->forward.at(0);
+      return previous;
+    }
+
+    bool operator==(const ConstIterator &rhs) const { return node == rhs.node; }
+    bool operator!=(const ConstIterator &rhs) const { return node != rhs.node; }
+
+  private:
+    const Node<V> *node = nullptr; ///< Node that iterator points to
+  };
+
+  /**
+   * Constructor of Deterministic Skip List
+   *
+   * Constructor takes no arguments. During object construction, head and nil
+   * Node are created. Head Node points to nil Node on all levels.
+   */
+  DeterministicSkipList();
+
+  /**
+   * Destructor of Deterministic Skip List
+   *
+   * During destruction, all elements of Deterministic Skip List are deleted.
+   */
+  ~DeterministicSkipList();
+
+  /// Disabling construction of Deterministic Skip List using copy constructor
+  DeterministicSkipList(const DeterministicSkipList &rhs) = delete;
+
+  /// Disabling construction of Deterministic Skip List using copy assignment
+  DeterministicSkipList &operator=(const DeterministicSkipList &rhs) = delete;
+
+  /**
+   * Insert Node to Deterministic Skip List
+   *
+   * New Node is inserted on level 0. If its gap grows to 4 Nodes, the second
+   * Node of the gap is promoted, which is repeated on upper levels. With
+   * CountedKeys policy, inserting already inserted key value increments its
+   * count.
+   *
+   * @tparam V newValue key value of Node
+   *
+   * @return true if Node with the same key value as newValue is not already
+   * inserted in Deterministic Skip List or policy is CountedKeys, else returns
+   * false
+   */
+  bool insertNode(AllComparison auto newValue);
+
+  /**
+   * Removes Node from Deterministic Skip List
+   *
+   * Node of level 1 is removed directly. Node of a higher level takes key
+   * value of its predecessor, which always has level 1, and the predecessor is
+   * removed instead. If a gap drops to 0 Nodes, it is merged with neighbouring
+   * gap by demoting the Node between them, which is repeated on upper levels.
+   * With CountedKeys policy, Node is removed together with all its duplicates.
+   *
+   * @tparam V value key value of Node
+   *
+   * @return true if Node with the same key value as value is
+   * deleted in Deterministic Skip List, else returns false
+   */
+  bool eraseNode(AllComparison auto value);
+
+  /**
+   * Search Node in Deterministic Skip List for given key value
+   *
+   * @tparam V value key value of Node
+   *
+   * @return true if Node with the same key value as value is
+   * inserted in Deterministic Skip List, else returns false
+   */
+  const bool searchNode(SearchNode auto value);
+
+  /**
+   * Number of inserted duplicates of key value, without printing
+   *
+   * @tparam V value key value of Node
+   *
+   * @return count kept in Node with CountedKeys policy, 1 with UniqueKeys
+   * policy if Node is inserted, 0 if Node is not inserted
+   */
+  std::size_t count(AllComparison auto value) const;
+
+  /**
+   * Removes one duplicate of key value
+   *
+   * With CountedKeys policy, count of Node is decremented and Node is removed
+   * when count drops to zero. With UniqueKeys policy, it is same as eraseNode.
+   *
+   * @tparam V value key value of Node
+   *
+   * @return true if Node with the same key value as value is
+   * inserted in Deterministic Skip List, else returns false
+   */
+  bool eraseOne(AllComparison auto value);
+
+  /**
+   * Removes Node with all duplicates of key value
+   *
+   * @tparam V value key value of Node
+   *
+   * @return number of removed duplicates, 0 if Node is not inserted
+   */
+  std::size_t eraseAll(AllComparison auto value);
+
+  /**
+   * Checks if Deterministic Skip List has no Nodes
+   *
+   * @return true if head Node points to nil Node on level 0
+   */
+  bool empty() const { return head->forward.at(0) == nil; }
+
+  /**
+   * Key value of Node with the lowest key value
+   *
+   * Deterministic Skip List must not be empty.
+   *
+   * @return key value of first Node after head
+   */
+  const V &front() const {
+    assert(!empty());
+    return head->forward.at(0)->value;
+  }
+
+  /**
+   * Removes one duplicate of Node with the lowest key value
+   *
+   * First Node always has level 1 and head as predecessor on every level, so
+   * no search is needed. With CountedKeys policy, count of Node is decremented
+   * and Node is removed when count drops to zero.
+   *
+   * @return true if Node is removed, false if Deterministic Skip List is empty
+   */
+  bool popFront();
+
+  /**
+   * Removes all Nodes with key value smaller than value
+   *
+   * @tparam V value key value of Node, first key value that is kept
+   *
+   * @return number of removed duplicates
+   */
+  std::size_t popFrontUntil(AllComparison auto value);
+
+  /**
+   * Removes all Nodes with key value smaller than value, calling visit with
+   * every removed key value
+   *
+   * @tparam V value key value of Node, first key value that is kept
+   * @param visit function called once for each removed duplicate
+   *
+   * @return number of removed duplicates
+   */
+  template <typename F>
+  std::size_t popFrontUntil(AllComparison auto value, F visit);
+
+  /**
+   * Iterator to the Node with the lowest key value
+   *
+   * @return iterator to first Node after head, equal to end() if Deterministic
+   * Skip List is empty
+   */
+  ConstIterator begin() const { return ConstIterator(head->forward.at(0)); }
+
+  /**
+   * Iterator past the Node with the highest key value
+   *
+   * @return iterator pointing to nil Node
+   */
+  ConstIterator end() const { return ConstIterator(nil); }
+
+  /**
+   * Range of Nodes with key value equal to value
+   *
+   * Range is per distinct key value, it holds at most one Node. With
+   * CountedKeys policy, duplicates are kept in that Node and their number is
+   * returned by count, not by the length of the range.
+   *
+   * @tparam V value key value of Node
+   *
+   * @return pair of iterators, first points to Node with key value not smaller
+   * than value, second past Node with key value equal to value. Range is empty
+   * if value is not inserted in Deterministic Skip List
+   */
+  std::pair<ConstIterator, ConstIterator>
+  equalRange(AllComparison auto value) const;
+};
+
+template <typename V, KeyPolicy P>
+DeterministicSkipList<V, P>::DeterministicSkipList() {
+  V valueMin = std::numeric_limits<V>::min();
+  head = new Node<V>(valueMin, maxLevel);
+
+  V valueMax = std::numeric_limits<V>::max();
+  nil = new Node<V>(valueMax, maxLevel);
+
+  for (int level = 0; level < maxLevel; ++level) {
+    head->forward.at(level) = nil;
+  }
+}
+
+template <typename V, KeyPolicy P>
+DeterministicSkipList<V, P>::~DeterministicSkipList() {
+  Node<V> *p = head;
+  while (p) {
+    head = p->forward.at(0);
+    delete p;
+    p = head;
+  }
+}
+
+template <typename V, KeyPolicy P>
+bool DeterministicSkipList<V, P>::insertNode(AllComparison auto newValue) {
+  std::vector<Node<V> *> tempNodeLevels(maxLevel + 1, head);
+  Node<V> *tempNode = findNode(newValue, tempNodeLevels);
+  if (tempNode != nil && tempNode->value == newValue) {
+    if constexpr (counted) {
+      tempNode->count++;
+      return true;
+    }
+    return false;
+  }
+
+  Node<V> *newNode = new Node<V>(newValue, 1);
+  newNode->forward.at(0) = tempNodeLevels.at(0)->forward.at(0);
+  tempNodeLevels.at(0)->forward.at(0) = newNode;
+  height = std::max(height, 1);
+
+  // Predecessors on upper levels are not changed by promotion on lower levels
+  for (int level = 0; level + 2 < maxLevel; ++level) {
+    Node<V> *predecessor = tempNodeLevels.at(level + 1);
+    if (gapSize(predecessor, level) <= maxGap)
+      break;
+    promote(predecessor, level);
+  }
+  return true;
+}
+
+template <typename V, KeyPolicy P>
+bool DeterministicSkipList<V, P>::eraseNode(AllComparison auto value) {
+  std::vector<Node<V> *> tempNodeLevels(maxLevel + 1, head);
+  Node<V> *tempNode = findNode(value, tempNodeLevels);
+  if ((tempNode == nil) || (tempNode->value != value))
+    return false;
+
+  eraseFoundNode(tempNode, tempNodeLevels);
+  return true;
+}
+
+template <typename V, KeyPolicy P>
+bool DeterministicSkipList<V, P>::eraseOne(AllComparison auto value) {
+  std::vector<Node<V> *> tempNodeLevels(maxLevel + 1, head);
+  Node<V> *tempNode = findNode(value, tempNodeLevels);
+  if ((tempNode == nil) || (tempNode->value != value))
+    return false;
+
+  if (!decrementCount(tempNode))
+    eraseFoundNode(tempNode, tempNodeLevels);
+  return true;
+}
+
+template <typename V, KeyPolicy P>
+std::size_t DeterministicSkipList<V, P>::eraseAll(AllComparison auto value) {
+  std::vector<Node<V> *> tempNodeLevels(maxLevel + 1, head);
+  Node<V> *tempNode = findNode(value, tempNodeLevels);
+  if ((tempNode == nil) || (tempNode->value != value))
+    return 0;
+
+  const std::size_t erased = nodeCount(tempNode);
+  eraseFoundNode(tempNode, tempNodeLevels);
+  return erased;
+}
+
+template <typename V, KeyPolicy P>
+const bool DeterministicSkipList<V, P>::searchNode(SearchNode auto value) {
+  Node<V> *searchNode = head;
+  for (int level = height - 1; level >= 0; --level) {
+    while (searchNode->forward.at(level)->value < value &&
+           searchNode->forward.at(level) != nil) {
+      searchNode = searchNode->forward.at(level);
+    }
+  }
+  searchNode = searchNode->forward.at(0);
+  if (searchNode != nil && searchNode->value == value) {
+    std::cout << "Found : ";
+    outputFunction(value);
+    return true;
+  }
+  return false;
+}
+
+template <typename V, KeyPolicy P>
+std::size_t
+DeterministicSkipList<V, P>::count(AllComparison auto value) const {
+  Node<V> *tempNode = lowerBound(value);
+  if ((tempNode != nil) && (tempNode->value == value))
+    return nodeCount(tempNode);
+  return 0;
+}
+
+template <typename V, KeyPolicy P>
+std::pair<typename DeterministicSkipList<V, P>::ConstIterator,
+          typename DeterministicSkipList<V, P>::ConstIterator>
+DeterministicSkipList<V, P>::equalRange(AllComparison auto value) const {
+  Node<V> *tempNode = lowerBound(value);
+  if ((tempNode != nil) && (tempNode->value == value))
+    return {ConstIterator(tempNode), ConstIterator(tempNode->forward.at(0))};
+  return {ConstIterator(tempNode), ConstIterator(tempNode)};
+}
+
+template <typename V, KeyPolicy P>
+bool DeterministicSkipList<V, P>::popFront() {
+  if (empty())
+    return false;
+  if (decrementCount(head->forward.at(0)))
+    return true;
+  std::vector<Node<V> *> tempNodeLevels(maxLevel + 1, head);
+  removeBottomNode(head->forward.at(0), tempNodeLevels);
+  return true;
+}
+
+template <typename V, KeyPolicy P>
+std::size_t
+DeterministicSkipList<V, P>::popFrontUntil(AllComparison auto value) {
+  return popFrontUntil(value, [](const V &) {});
+}
+
+template <typename V, KeyPolicy P>
+template <typename F>
+std::size_t
+DeterministicSkipList<V, P>::popFrontUntil(AllComparison auto value,
+                                           F visit) {
+  std::size_t popped = 0;
+  std::vector<Node<V> *> tempNodeLevels(maxLevel + 1, head);
+  Node<V> *tempNode = head->forward.at(0);
+  while (tempNode != nil && tempNode->value < value) {
+    const std::size_t duplicates = nodeCount(tempNode);
+    for (size_t i = 0; i < duplicates; ++i) {
+      visit(tempNode->value);
+    }
+    popped += duplicates;
+    removeBottomNode(tempNode, tempNodeLevels);
+    tempNode = head->forward.at(0);
+  }
+  return popped;
+}
+
+template <typename V, KeyPolicy P>
+auto DeterministicSkipList<V, P>::findNode(
+    const V &value, std::vector<Node<V> *> &tempNodeLevels) const
+    -> Node<V> * {
+  Node<V> *tempNode = head;
+  for (int level = height - 1; level >= 0; --level) {
+    while (tempNode->forward.at(level)->value < value &&
+           tempNode->forward.at(level) != nil) {
+      tempNode = tempNode->forward.at(level);
+    }
+    tempNodeLevels.at(level) = tempNode;
+  }
+  return tempNode->forward.at(0);
+}
+
+template <typename V, KeyPolicy P>
+auto DeterministicSkipList<V, P>::lowerBound(const V &value) const
+    -> Node<V> * {
+  Node<V> *tempNode = head;
+  for (int level = height - 1; level >= 0; --level) {
+    while (tempNode->forward.at(level)->value < value &&
+           tempNode->forward.at(level) != nil) {
+      tempNode = tempNode->forward.at(level);
+    }
+  }
+  return tempNode->forward.at(0);
+}
+
+template <typename V, KeyPolicy P>
+void DeterministicSkipList<V, P>::eraseFoundNode(
+    Node<V> *node, std::vector<Node<V> *> &tempNodeLevels) {
+  if (node->forward.size() > 1) {
+    // Gap before Node of a higher level is never empty, so predecessor on
+    // level 0 has level 1 and shares predecessors on all upper levels
+    Node<V> *predecessor = tempNodeLevels.at(0);
+    node->value = predecessor->value;
+    if constexpr (counted)
+      node->count = predecessor->count;
+    Node<V> *p = tempNodeLevels.at(1);
+    while (p->forward.at(0) != predecessor) {
+      p = p->forward.at(0);
+    }
+    tempNodeLevels.at(0) = p;
+    node = predecessor;
+  }
+  removeBottomNode(node, tempNodeLevels);
+}
+
+template <typename V, KeyPolicy P>
+int DeterministicSkipList<V, P>::gapSize(Node<V> *node, int level) const {
+  int size = 0;
+  Node<V> *last = node->forward.at(level + 1);
+  for (Node<V> *p = node->forward.at(level); p != last;
+       p = p->forward.at(level)) {
+    size++;
+  }
+  return size;
+}
+
+template <typename V, KeyPolicy P>
+void DeterministicSkipList<V, P>::promote(Node<V> *node, int level) {
+  Node<V> *second = node->forward.at(level)->forward.at(level);
+  second->forward.push_back(node->forward.at(level + 1));
+  node->forward.at(level + 1) = second;
+  height = std::max(height, level + 2);
+}
+
+template <typename V, KeyPolicy P>
+void DeterministicSkipList<V, P>::removeBottomNode(
+    Node<V> *node, const std::vector<Node<V> *> &tempNodeLevels) {
+  tempNodeLevels.at(0)->forward.at(0) = node->forward.at(0);
+  delete node;
+
+  for (int level = 0; level + 1 < maxLevel; ++level) {
+    Node<V> *left = tempNodeLevels.at(level + 1);
+    Node<V> *right = left->forward.at(level + 1);
+    if (gapSize(left, level) > 0)
+      break;
+    if (left == head && right == nil) {
+      // Top level is empty
+      height = level;
+      break;
+    }
+
+    // Merge empty gap with neighbouring gap of the same parent gap by
+    // demoting the Node between them
+    Node<V> *gapStart = left;
+    if (right != nil && right->forward.size() == size_t(level + 2)) {
+      left->forward.at(level + 1) = right->forward.at(level + 1);
+      right->forward.pop_back();
+    } else {
+      gapStart = tempNodeLevels.at(level + 2);
+      while (gapStart->forward.at(level + 1) != left) {
+        gapStart = gapStart->forward.at(level + 1);
+      }
+      gapStart->forward.at(level + 1) = left->forward.at(level + 1);
+      left->forward.pop_back();
+    }
+
+    // Merged gap of 4 Nodes is split again, parent gap keeps its size
+    if (gapSize(gapStart, level) > maxGap) {
+      promote(gapStart, level);
+      break;
+    }
+  }
+}
+
+} // namespace list
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+namespace list {
+
+/**
+ * Implementation of the Lookup Task class.
+ *
+ * Lookup Task is coroutine of a single lookup in a list, used by lookupMany
+ * function of SkipList class. Lookup suspends each time it is about to read a
+ * Node that is likely not in cache, after prefetching it. Scheduler resumes
+ * other lookups meanwhile, so memory requests of several lookups are in flight
+ * at the same time instead of one dependent cache miss after another.
+ */
+class LookupTask {
+public:
+  /**
+   * Promise of Lookup Task, carries result of the lookup.
+   *
+   * Lookup starts suspended and stays suspended after it finishes, so
+   * scheduler decides when it runs and reads the result before destroying it.
+   */
+  struct promise_type {
+    bool found = false; ///< true if looked up key value is found
+
+    LookupTask get_return_object() {
+      return LookupTask(
+          std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    void return_value(bool value) { found = value; }
+    void unhandled_exception() { std::terminate(); }
+  };
+
+  /**
+   * Awaiter that prefetches memory at address and suspends the lookup.
+   */
+  struct Prefetch {
+    const void *address; ///< address that will be read after resume
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<>) const noexcept {
+      __builtin_prefetch(address);
+    }
+    void await_resume() const noexcept {}
+  };
+
+  LookupTask() = default;
+
+  /**
+   * Lookup Task constructor.
+   *
+   * @param handle handle of coroutine frame owned by Lookup Task
+   */
+  explicit LookupTask(std::coroutine_handle<promise_type> handle)
+      : handle(handle) {}
+
+  ~LookupTask() {
+    if (handle)
+      handle.destroy();
+  }
+
+  /// Disabling construction of Lookup Task using copy constructor
+  LookupTask(const LookupTask &rhs) = delete;
+
+  /// Disabling construction of Lookup Task using copy assignment
+  LookupTask &operator=(const LookupTask &rhs) = delete;
+
+  LookupTask(LookupTask &&rhs) noexcept
+      : handle(std::exchange(rhs.handle, nullptr)) {}
+
+  LookupTask &operator=(LookupTask &&rhs) noexcept {
+    if (this != &rhs) {
+      if (handle)
+        handle.destroy();
+      handle = std::exchange(rhs.handle, nullptr);
+    }
+    return *this;
+  }
+
+  /// Runs lookup until it suspends on next prefetch or finishes
+  void resume() { handle.resume(); }
+
+  /// @return true if lookup is finished
+  bool done() const { return handle.done(); }
+
+  /// @return true if finished lookup found key value
+  bool found() const { return handle.promise().found; }
+
+private:
+  std::coroutine_handle<promise_type> handle{}; ///< owned coroutine frame
+};
+
+} // namespace list
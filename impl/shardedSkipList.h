@@ -0,0 +1,268 @@
+#pragma once
+
+#include "skipList.h"
+#include <array>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+namespace list {
+
+/**
+ * Default partitioner of ShardedSkipList, which spreads key values across
+ * shards using std::hash.
+ *
+ * @tparam V type of data stored in Sharded Skip List
+ */
+template <typename V> struct HashPartitioner {
+  std::size_t operator()(const V &value) const {
+    return std::hash<V>{}(value);
+  }
+};
+
+/**
+ * Implementation of the Sharded Skip List class.
+ *
+ * Sharded Skip List partitions key values across N inner SkipList objects,
+ * each guarded by its own reader-writer lock. Writes to different shards run
+ * in parallel, searches of the same shard share the lock. Partitioner decides
+ * which shard owns a key value: default HashPartitioner spreads keys evenly,
+ * a user defined partitioner can map key ranges to shards instead.
+ *
+ * @tparam V type of data stored in Sharded Skip List
+ * @tparam N number of shards
+ * @tparam Partitioner function object mapping key value to shard, result is
+ * taken modulo N
+ */
+template <typename V, std::size_t N, typename Partitioner = HashPartitioner<V>>
+class ShardedSkipList {
+  static_assert(N > 0, "Sharded Skip List needs at least one shard");
+
+private:
+  /**
+   * Implementation of the Shard structure.
+   *
+   * Each Shard carries inner Skip List and lock guarding it. Shards are cache
+   * line aligned, so locks of neighbouring shards do not share a cache line.
+   */
+  struct alignas(64) Shard {
+    mutable std::shared_mutex mutex; ///< reader-writer lock of Shard
+    SkipList<V> list;                ///< Skip List holding Shard key values
+  };
+
+  std::array<Shard, N> shards; ///< shards of Sharded Skip List
+
+  Partitioner partitioner; ///< maps key value to shard
+
+  /**
+   * Calculates index of shard owning key value
+   *
+   * @tparam V value key value of Node
+   *
+   * @return index of shard in range [0, N)
+   */
+  std::size_t shardIndex(const V &value) const {
+    return partitioner(value) % N;
+  }
+
+public:
+  /**
+   * Constructor of Sharded Skip List
+   *
+   * @param partitioner function object mapping key value to shard
+   */
+  explicit ShardedSkipList(Partitioner partitioner = Partitioner())
+      : partitioner(partitioner) {}
+
+  /// Disabling construction of Sharded Skip List object using copy constructor
+  ShardedSkipList(const ShardedSkipList &rhs) = delete;
+
+  /// Disabling construction of Sharded Skip List object using copy assignment
+  ShardedSkipList &operator=(const ShardedSkipList &rhs) = delete;
+
+  /**
+   * Insert Node to shard owning newValue, holding shard's exclusive lock
+   *
+   * @tparam V newValue key value of Node
+   *
+   * @return true if Node with the same key value as newValue is not already
+   * inserted in Sharded Skip List, else returns false
+   */
+  bool insertNode(AllComparison auto newValue);
+
+  /**
+   * Removes Node from shard owning value, holding shard's exclusive lock
+   *
+   * @tparam V value key value of Node
+   *
+   * @return true if Node with the same key value as value is
+   * deleted in Sharded Skip List, else returns false
+   */
+  bool eraseNode(AllComparison auto value);
+
+  /**
+   * Search Node in shard owning value, holding shard's shared lock
+   *
+   * @tparam V value key value of Node
+   *
+   * @return true if Node with the same key value as value is
+   * inserted in Sharded Skip List, else returns false
+   */
+  const bool searchNode(SearchNode auto value);
+
+  /**
+   * Number of Nodes with key value equal to value, holding shard's shared
+   * lock
+   *
+   * Unlike searchNode, nothing is printed, so count is suitable for readers
+   * running at the same time.
+   *
+   * @tparam V value key value of Node
+   *
+   * @return 1 if Node is inserted, 0 if Node is not inserted
+   */
+  std::size_t count(AllComparison auto value) const;
+
+  /**
+   * Insert batch of Nodes to Sharded Skip List
+   *
+   * Values are grouped by shard first, so exclusive lock of each shard is
+   * taken only once for the whole batch.
+   *
+   * @param values key values of Nodes
+   *
+   * @return number of inserted Nodes, duplicates are not counted
+   */
+  std::size_t insertBatch(const std::vector<V> &values);
+
+  /**
+   * Removes batch of Nodes from Sharded Skip List
+   *
+   * Values are grouped by shard first, so exclusive lock of each shard is
+   * taken only once for the whole batch.
+   *
+   * @param values key values of Nodes
+   *
+   * @return number of deleted Nodes
+   */
+  std::size_t eraseBatch(const std::vector<V> &values);
+
+  /**
+   * Visits all key values in order, from the lowest to the highest
+   *
+   * Shared locks of all shards are taken in shard order, and shards are
+   * merged using k-way merge over shard iterators. Writers take only one
+   * shard lock at a time, so lock order can not deadlock.
+   *
+   * @param visit function called with each key value
+   */
+  template <typename F> void forEach(F visit) const;
+};
+
+template <typename V, std::size_t N, typename Partitioner>
+bool ShardedSkipList<V, N, Partitioner>::insertNode(
+    AllComparison auto newValue) {
+  Shard &shard = shards.at(shardIndex(newValue));
+  std::unique_lock lock(shard.mutex);
+  return shard.list.insertNode(newValue);
+}
+
+template <typename V, std::size_t N, typename Partitioner>
+bool ShardedSkipList<V, N, Partitioner>::eraseNode(AllComparison auto value) {
+  Shard &shard = shards.at(shardIndex(value));
+  std::unique_lock lock(shard.mutex);
+  return shard.list.eraseNode(value);
+}
+
+template <typename V, std::size_t N, typename Partitioner>
+const bool
+ShardedSkipList<V, N, Partitioner>::searchNode(SearchNode auto value) {
+  Shard &shard = shards.at(shardIndex(value));
+  std::shared_lock lock(shard.mutex);
+  return shard.list.searchNode(value);
+}
+
+template <typename V, std::size_t N, typename Partitioner>
+std::size_t
+ShardedSkipList<V, N, Partitioner>::count(AllComparison auto value) const {
+  const Shard &shard = shards.at(shardIndex(value));
+  std::shared_lock lock(shard.mutex);
+  return shard.list.count(value);
+}
+
+template <typename V, std::size_t N, typename Partitioner>
+std::size_t
+ShardedSkipList<V, N, Partitioner>::insertBatch(const std::vector<V> &values) {
+  std::array<std::vector<V>, N> groups;
+  for (const V &value : values) {
+    groups.at(shardIndex(value)).push_back(value);
+  }
+
+  std::size_t inserted = 0;
+  for (std::size_t i = 0; i < N; ++i) {
+    if (groups.at(i).empty())
+      continue;
+    std::unique_lock lock(shards.at(i).mutex);
+    for (const V &value : groups.at(i)) {
+      if (shards.at(i).list.insertNode(value))
+        inserted++;
+    }
+  }
+  return inserted;
+}
+
+template <typename V, std::size_t N, typename Partitioner>
+std::size_t
+ShardedSkipList<V, N, Partitioner>::eraseBatch(const std::vector<V> &values) {
+  std::array<std::vector<V>, N> groups;
+  for (const V &value : values) {
+    groups.at(shardIndex(value)).push_back(value);
+  }
+
+  std::size_t erased = 0;
+  for (std::size_t i = 0; i < N; ++i) {
+    if (groups.at(i).empty())
+      continue;
+    std::unique_lock lock(shards.at(i).mutex);
+    for (const V &value : groups.at(i)) {
+      if (shards.at(i).list.eraseNode(value))
+        erased++;
+    }
+  }
+  return erased;
+}
+
+template <typename V, std::size_t N, typename Partitioner>
+template <typename F>
+void ShardedSkipList<V, N, Partitioner>::forEach(F visit) const {
+  std::array<std::shared_lock<std::shared_mutex>, N> locks;
+  for (std::size_t i = 0; i < N; ++i) {
+    locks.at(i) = std::shared_lock(shards.at(i).mutex);
+  }
+
+  // Cursor is position in shard paired with shard index, heap keeps cursor
+  // with the lowest key value on top
+  using Cursor = std::pair<typename SkipList<V>::ConstIterator, std::size_t>;
+  auto greater = [](const Cursor &lhs, const Cursor &rhs) {
+    return *rhs.first < *lhs.first;
+  };
+  std::priority_queue<Cursor, std::vector<Cursor>, decltype(greater)> heap(
+      greater);
+  for (std::size_t i = 0; i < N; ++i) {
+    if (shards.at(i).list.begin() != shards.at(i).list.end())
+      heap.emplace(shards.at(i).list.begin(), i);
+  }
+
+  while (!heap.empty()) {
+    Cursor cursor = heap.top();
+    heap.pop();
+    visit(*cursor.first);
+    if (++cursor.first != shards.at(cursor.second).list.end())
+      heap.push(cursor);
+  }
+}
+
+} // namespace list
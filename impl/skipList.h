@@ -1,12 +1,16 @@
 #pragma once
 
+#include "lookupTask.h"
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <concepts>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <math.h>
 #include <random>
+#include <utility>
 #include <vector>
 
 namespace list {
@@ -61,6 +65,27 @@ concept Printable = HasToStringFunction<T> || IsStringable<T>;
  */
 template <typename T> concept SearchNode = AllComparison<T> &&Printable<T>;
 
+/**
+ * Key policy of SkipList, where inserting already inserted key value is
+ * rejected.
+ */
+struct UniqueKeys {};
+
+/**
+ * Key policy of SkipList, where inserting already inserted key value
+ * increments count of duplicates kept in Node, so Skip List acts as multiset.
+ * Duplicates share one Node: iteration and equalRange visit each distinct key
+ * value once, multiplicity of key value is available only through count.
+ */
+struct CountedKeys {};
+
+/**
+ * KeyPolicy concept, which specifies the requirement on key policy template
+ * argument of SkipList class. Key policy is either UniqueKeys or CountedKeys.
+ */
+template <typename P>
+concept KeyPolicy = std::same_as<P, UniqueKeys> || std::same_as<P, CountedKeys>;
+
 /**
  * Implementation of the Skip List class.
  *
@@ -69,9 +94,16 @@ template <typename T> concept SearchNode = AllComparison<T> &&Printable<T>;
  * following W. Pugh's paper: ftp://ftp.cs.umd.edu/pub/skipLists/skiplists.pdf
  *
  * @tparam V type of data stored in Skip List
+ * @tparam P key policy, UniqueKeys rejects duplicates, CountedKeys counts them
  */
-template <typename V> class SkipList {
+template <typename V, KeyPolicy P = UniqueKeys> class SkipList {
 private:
+  /// true if Nodes keep number of duplicates, set by CountedKeys policy
+  static constexpr bool counted = std::same_as<P, CountedKeys>;
+
+  /// Placeholder for count of Node with UniqueKeys policy, takes no space
+  struct NoCount {};
+
   /**
    * Implementation of the Node structure.
    *
@@ -82,6 +114,8 @@ private:
    */
   template <typename T> struct Node {
     T value; ///< key value of Node
+    [[no_unique_address]] std::conditional_t<counted, std::size_t, NoCount>
+        count{}; ///< number of duplicates, kept only with CountedKeys policy
     std::vector<Node<T> *>
         forward{}; ///< forward vector carrying pointers to nodes, with same
     ///< values, but on a different levels
@@ -95,7 +129,10 @@ private:
      * @tparam T data type of key in Node
      * @param level level size determined using random number generator
      */
-    explicit Node(T v, int level) : value(v), forward(level, nullptr) {}
+    explicit Node(T v, int level) : value(v), forward(level, nullptr) {
+      if constexpr (counted)
+        count = 1;
+    }
   };
 
   /**
@@ -161,7 +198,126 @@ private:
     std::cout << std::to_string(value) << std::endl;
   };
 
+  /**
+   * Fetches predecessors of key value on all levels
+   *
+   * @tparam V value key value of Node
+   * @param tempNodeLevels filled with last Node before value on each level
+   *
+   * @return first Node with key value not smaller than value, or nil
+   */
+  Node<V> *findNode(const V &value, std::vector<Node<V> *> &tempNodeLevels);
+
+  /**
+   * Search first Node with key value not smaller than value, without
+   * fetching predecessors
+   *
+   * @tparam V value key value of Node
+   *
+   * @return first Node with key value not smaller than value, or nil
+   */
+  Node<V> *lowerBound(const V &value) const;
+
+  /**
+   * Connects predecessors and successors of Node and deletes it
+   *
+   * @param node Node to be removed
+   * @param tempNodeLevels predecessors of node on all levels
+   */
+  void unlinkNode(Node<V> *node, const std::vector<Node<V> *> &tempNodeLevels);
+
+  /**
+   * Number of duplicates kept in Node
+   *
+   * @param node Node of Skip List
+   *
+   * @return count of Node with CountedKeys policy, 1 with UniqueKeys policy
+   */
+  static std::size_t nodeCount(const Node<V> *node) {
+    if constexpr (counted)
+      return node->count;
+    else
+      return 1;
+  }
+
+  /**
+   * Removes one duplicate from Node, if Node carries more than one
+   *
+   * @param node Node of Skip List
+   *
+   * @return true if count of Node is decremented, false if Node carries one
+   * duplicate and has to be removed
+   */
+  static bool decrementCount(Node<V> *node) {
+    if constexpr (counted) {
+      if (node->count > 1) {
+        node->count--;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Coroutine of a single lookup used by lookupMany
+   *
+   * Lookup prefetches every Node it is about to read and suspends, before
+   * reading Node's key value and forward vector.
+   *
+   * @tparam V value key value of Node
+   *
+   * @return task, which result is true if Node with the same key value as
+   * value is inserted in Skip List
+   */
+  LookupTask lookupTask(V value) const;
+
 public:
+  /**
+   * Forward iterator over Skip List values.
+   *
+   * Iterator walks level 0 of Skip List, from the lowest to the highest key
+   * value. Values can only be read, ordering of Skip List is kept by
+   * insertNode and eraseNode functions. Each Node is visited once, so with
+   * CountedKeys policy duplicates of key value are visited once as well.
+   */
+  class ConstIterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = V;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const V *;
+    using reference = const V &;
+
+    ConstIterator() = default;
+
+    /**
+     * Iterator constructor.
+     *
+     * @param node Node of Skip List that iterator points to
+     */
+    explicit ConstIterator(const Node<V> *node) : node(node) {}
+
+    const V &operator*() const { return node->value; }
+    const V *operator->() const { return &node->value; }
+
+    ConstIterator &operator++() {
+      node = node->forward.at(0);
+      return *this;
+    }
+
+    ConstIterator operator++(int) {
+      ConstIterator previous = *this;
+      node = node->forward.at(0);
+      return previous;
+    }
+
+    bool operator==(const ConstIterator &rhs) const { return node == rhs.node; }
+    bool operator!=(const ConstIterator &rhs) const { return node != rhs.node; }
+
+  private:
+    const Node<V> *node = nullptr; ///< Node that iterator points to
+  };
+
   /**
    * Constructor of Skip List
    *
@@ -190,12 +346,13 @@ public:
    *
    * Nodes are inserted in order, from the lowest to the highest key value. All
    * links for Node that's to be inserted are fetched. Pointers of predecessors
-   * and new Node, and new Node and successors are connected.
+   * and new Node, and new Node and successors are connected. With CountedKeys
+   * policy, inserting already inserted key value increments its count.
    *
    * @tparam V newValue key value of Node
    *
    * @return true if Node with the same key value as newValue is not already
-   * inserted in Skip List, else returns false
+   * inserted in Skip List or policy is CountedKeys, else returns false
    */
   bool insertNode(AllComparison auto newValue);
 
@@ -203,7 +360,8 @@ public:
    * Removes Node from Skip List
    *
    * All links for Node that's to be removed are fetched. Pointers of
-   * predecessors and successors of removed Node are connected.
+   * predecessors and successors of removed Node are connected. With
+   * CountedKeys policy, Node is removed together with all its duplicates.
    *
    * @tparam V value key value of Node
    *
@@ -222,6 +380,139 @@ public:
    */
   const bool searchNode(SearchNode auto value);
 
+  /**
+   * Number of inserted duplicates of key value
+   *
+   * @tparam V value key value of Node
+   *
+   * @return count kept in Node with CountedKeys policy, 1 with UniqueKeys
+   * policy if Node is inserted, 0 if Node is not inserted
+   */
+  std::size_t count(AllComparison auto value) const;
+
+  /**
+   * Removes one duplicate of key value
+   *
+   * With CountedKeys policy, count of Node is decremented and Node is removed
+   * when count drops to zero. With UniqueKeys policy, it is same as eraseNode.
+   *
+   * @tparam V value key value of Node
+   *
+   * @return true if Node with the same key value as value is
+   * inserted in Skip List, else returns false
+   */
+  bool eraseOne(AllComparison auto value);
+
+  /**
+   * Removes Node with all duplicates of key value
+   *
+   * @tparam V value key value of Node
+   *
+   * @return number of removed duplicates, 0 if Node is not inserted
+   */
+  std::size_t eraseAll(AllComparison auto value);
+
+  /**
+   * Search many key values, interleaving lookups
+   *
+   * Each lookup is coroutine, which suspends after prefetching the next Node.
+   * Up to inFlight lookups are resumed in round-robin order, so their cache
+   * misses overlap. Useful for Skip Lists much larger than cache. Unlike
+   * searchNode, found key values are not printed.
+   *
+   * @param values key values to be searched
+   * @param inFlight number of lookups running at the same time
+   *
+   * @return for each value, true if Node with the same key value is inserted
+   * in Skip List, else false
+   */
+  std::vector<bool> lookupMany(const std::vector<V> &values,
+                               std::size_t inFlight = 16) const;
+
+  /**
+   * Checks if Skip List has no Nodes
+   *
+   * @return true if head Node points to nil Node on level 0
+   */
+  bool empty() const { return head->forward.at(0) == nil; }
+
+  /**
+   * Key value of Node with the lowest key value
+   *
+   * Skip List must not be empty.
+   *
+   * @return key value of first Node after head
+   */
+  const V &front() const {
+    assert(!empty());
+    return head->forward.at(0)->value;
+  }
+
+  /**
+   * Removes one duplicate of Node with the lowest key value
+   *
+   * Predecessor of the first Node is head on every level, so no search is
+   * needed and removal takes O(level of Node). With CountedKeys policy, count
+   * of Node is decremented and Node is removed when count drops to zero.
+   *
+   * @return true if Node is removed, false if Skip List is empty
+   */
+  bool popFront();
+
+  /**
+   * Removes all Nodes with key value smaller than value
+   *
+   * Nodes are popped from the front of Skip List, so no search is needed.
+   *
+   * @tparam V value key value of Node, first key value that is kept
+   *
+   * @return number of removed duplicates
+   */
+  std::size_t popFrontUntil(AllComparison auto value);
+
+  /**
+   * Removes all Nodes with key value smaller than value, calling visit with
+   * every removed key value
+   *
+   * @tparam V value key value of Node, first key value that is kept
+   * @param visit function called once for each removed duplicate
+   *
+   * @return number of removed duplicates
+   */
+  template <typename F>
+  std::size_t popFrontUntil(AllComparison auto value, F visit);
+
+  /**
+   * Iterator to the Node with the lowest key value
+   *
+   * @return iterator to first Node after head, equal to end() if Skip List is
+   * empty
+   */
+  ConstIterator begin() const { return ConstIterator(head->forward.at(0)); }
+
+  /**
+   * Iterator past the Node with the highest key value
+   *
+   * @return iterator pointing to nil Node
+   */
+  ConstIterator end() const { return ConstIterator(nil); }
+
+  /**
+   * Range of Nodes with key value equal to value
+   *
+   * Range is per distinct key value, it holds at most one Node. With
+   * CountedKeys policy, duplicates are kept in that Node and their number is
+   * returned by count, not by the length of the range.
+   *
+   * @tparam V value key value of Node
+   *
+   * @return pair of iterators, first points to Node with key value not smaller
+   * than value, second past Node with key value equal to value. Range is empty
+   * if value is not inserted in Skip List
+   */
+  std::pair<ConstIterator, ConstIterator>
+  equalRange(AllComparison auto value) const;
+
   /**
    * Operator == overloading function, friend of a SkipList class
    *
@@ -253,7 +544,7 @@ public:
   template <typename U> friend bool operator<(const U &lhs, const U &rhs);
 };
 
-template <typename V> SkipList<V>::SkipList() {
+template <typename V, KeyPolicy P> SkipList<V, P>::SkipList() {
   V valueMin = std::numeric_limits<V>::min();
   head = new Node<V>(valueMin, maxLevel);
 
@@ -267,7 +558,7 @@ template <typename V> SkipList<V>::SkipList() {
   }
 }
 
-template <typename V> SkipList<V>::~SkipList() {
+template <typename V, KeyPolicy P> SkipList<V, P>::~SkipList() {
   Node<V> *p = head;
   while (p) {
     head = p->forward.at(0);
@@ -288,8 +579,8 @@ template <typename V> bool operator<(const V &lhs, const V &rhs) {
   return lhs.value < rhs.value;
 }
 
-template <typename V>
-bool SkipList<V>::insertNode(AllComparison auto newValue) {
+template <typename V, KeyPolicy P>
+bool SkipList<V, P>::insertNode(AllComparison auto newValue) {
   Node<V> *tempNode = head;
   std::vector<Node<V> *> tempNodeLevels(maxLevel, nullptr);
   for (level = maxLevel - 1; level >= 0; --level) {
@@ -302,6 +593,10 @@ bool SkipList<V>::insertNode(AllComparison auto newValue) {
 
   tempNode = tempNode->forward.at(0);
   if (tempNode != nil && tempNode->value == newValue) {
+    if constexpr (counted) {
+      tempNode->count++;
+      return true;
+    }
     return false;
   } else {
     const int newNodeLevel = getRandomLevel();
@@ -316,9 +611,160 @@ bool SkipList<V>::insertNode(AllComparison auto newValue) {
   return true;
 }
 
-template <typename V> bool SkipList<V>::eraseNode(AllComparison auto value) {
-  Node<V> *tempNode = head;
+template <typename V, KeyPolicy P>
+bool SkipList<V, P>::eraseNode(AllComparison auto value) {
+  std::vector<Node<V> *> tempNodeLevels(maxLevel, nullptr);
+  Node<V> *tempNode = findNode(value, tempNodeLevels);
+  if ((tempNode != nil) && (tempNode->value == value)) {
+    unlinkNode(tempNode, tempNodeLevels);
+    return true;
+  }
+  return false;
+}
+
+template <typename V, KeyPolicy P>
+bool SkipList<V, P>::eraseOne(AllComparison auto value) {
   std::vector<Node<V> *> tempNodeLevels(maxLevel, nullptr);
+  Node<V> *tempNode = findNode(value, tempNodeLevels);
+  if ((tempNode == nil) || (tempNode->value != value))
+    return false;
+
+  if (!decrementCount(tempNode))
+    unlinkNode(tempNode, tempNodeLevels);
+  return true;
+}
+
+template <typename V, KeyPolicy P>
+std::size_t SkipList<V, P>::eraseAll(AllComparison auto value) {
+  std::vector<Node<V> *> tempNodeLevels(maxLevel, nullptr);
+  Node<V> *tempNode = findNode(value, tempNodeLevels);
+  if ((tempNode == nil) || (tempNode->value != value))
+    return 0;
+
+  const std::size_t erased = nodeCount(tempNode);
+  unlinkNode(tempNode, tempNodeLevels);
+  return erased;
+}
+
+template <typename V, KeyPolicy P>
+std::size_t SkipList<V, P>::count(AllComparison auto value) const {
+  Node<V> *tempNode = lowerBound(value);
+  if ((tempNode != nil) && (tempNode->value == value))
+    return nodeCount(tempNode);
+  return 0;
+}
+
+template <typename V, KeyPolicy P>
+std::pair<typename SkipList<V, P>::ConstIterator,
+          typename SkipList<V, P>::ConstIterator>
+SkipList<V, P>::equalRange(AllComparison auto value) const {
+  Node<V> *tempNode = lowerBound(value);
+  if ((tempNode != nil) && (tempNode->value == value))
+    return {ConstIterator(tempNode), ConstIterator(tempNode->forward.at(0))};
+  return {ConstIterator(tempNode), ConstIterator(tempNode)};
+}
+
+template <typename V, KeyPolicy P> bool SkipList<V, P>::popFront() {
+  Node<V> *tempNode = head->forward.at(0);
+  if (tempNode == nil)
+    return false;
+
+  if (decrementCount(tempNode))
+    return true;
+  for (size_t i = 0; i < tempNode->forward.size(); ++i) {
+    head->forward.at(i) = tempNode->forward.at(i);
+  }
+  delete tempNode;
+  return true;
+}
+
+template <typename V, KeyPolicy P>
+std::size_t SkipList<V, P>::popFrontUntil(AllComparison auto value) {
+  return popFrontUntil(value, [](const V &) {});
+}
+
+template <typename V, KeyPolicy P>
+template <typename F>
+std::size_t SkipList<V, P>::popFrontUntil(AllComparison auto value, F visit) {
+  std::size_t popped = 0;
+  Node<V> *tempNode = head->forward.at(0);
+  while (tempNode != nil && tempNode->value < value) {
+    const std::size_t duplicates = nodeCount(tempNode);
+    for (size_t i = 0; i < duplicates; ++i) {
+      visit(tempNode->value);
+    }
+    popped += duplicates;
+    for (size_t i = 0; i < tempNode->forward.size(); ++i) {
+      head->forward.at(i) = tempNode->forward.at(i);
+    }
+    delete tempNode;
+    tempNode = head->forward.at(0);
+  }
+  return popped;
+}
+
+template <typename V, KeyPolicy P>
+std::vector<bool> SkipList<V, P>::lookupMany(const std::vector<V> &values,
+                                             std::size_t inFlight) const {
+  std::vector<bool> found(values.size(), false);
+  // Each slot carries running lookup and index of its value
+  std::vector<std::pair<LookupTask, std::size_t>> slots;
+  const std::size_t slotCount = std::max<std::size_t>(inFlight, 1);
+  std::size_t next = 0;
+  while (next < values.size() && slots.size() < slotCount) {
+    slots.emplace_back(lookupTask(values.at(next)), next);
+    next++;
+  }
+
+  while (!slots.empty()) {
+    for (std::size_t i = 0; i < slots.size();) {
+      LookupTask &task = slots.at(i).first;
+      task.resume();
+      if (!task.done()) {
+        ++i;
+        continue;
+      }
+      found.at(slots.at(i).second) = task.found();
+      if (next < values.size()) {
+        slots.at(i) = {lookupTask(values.at(next)), next};
+        next++;
+        ++i;
+      } else {
+        slots.at(i) = std::move(slots.back());
+        slots.pop_back();
+      }
+    }
+  }
+  return found;
+}
+
+template <typename V, KeyPolicy P>
+LookupTask SkipList<V, P>::lookupTask(V value) const {
+  Node<V> *tempNode = head;
+  // Node that stopped search on upper level is already in cache
+  Node<V> *checkedNode = nil;
+  for (int searchLevel = maxLevel - 1; searchLevel >= 0; --searchLevel) {
+    Node<V> *nextNode = tempNode->forward[searchLevel];
+    while (nextNode != nil) {
+      if (nextNode != checkedNode)
+        co_await LookupTask::Prefetch{nextNode};
+      checkedNode = nextNode;
+      if (!(nextNode->value < value))
+        break;
+      tempNode = nextNode;
+      co_await LookupTask::Prefetch{tempNode->forward.data() + searchLevel};
+      nextNode = tempNode->forward[searchLevel];
+    }
+  }
+  tempNode = tempNode->forward[0];
+  co_return tempNode != nil && tempNode->value == value;
+}
+
+template <typename V, KeyPolicy P>
+auto SkipList<V, P>::findNode(const V &value,
+                              std::vector<Node<V> *> &tempNodeLevels)
+    -> Node<V> * {
+  Node<V> *tempNode = head;
   for (level = maxLevel - 1; level >= 0; --level) {
     while (tempNode->forward.at(level)->value < value &&
            tempNode->forward.at(level) != nil) {
@@ -326,25 +772,40 @@ template <typename V> bool SkipList<V>::eraseNode(AllComparison auto value) {
     }
     tempNodeLevels.at(level) = tempNode;
   }
+  return tempNode->forward.at(0);
+}
 
-  tempNode = tempNodeLevels.at(0)->forward.at(0);
-  if ((tempNode->value == value) && (tempNode != nil)) {
-    for (size_t i = 0; i < tempNodeLevels.size(); ++i) {
-      if (tempNodeLevels.at(i)->forward.at(i) == tempNode)
-        tempNodeLevels.at(i)->forward.at(i) = tempNode->forward.at(i);
+template <typename V, KeyPolicy P>
+auto SkipList<V, P>::lowerBound(const V &value) const -> Node<V> * {
+  Node<V> *tempNode = head;
+  for (int searchLevel = maxLevel - 1; searchLevel >= 0; --searchLevel) {
+    while (tempNode->forward.at(searchLevel)->value < value &&
+           tempNode->forward.at(searchLevel) != nil) {
+      tempNode = tempNode->forward.at(searchLevel);
     }
-    return true;
   }
-  return false;
+  return tempNode->forward.at(0);
 }
 
-template <typename V>
-const bool SkipList<V>::searchNode(SearchNode auto value) {
+template <typename V, KeyPolicy P>
+void SkipList<V, P>::unlinkNode(Node<V> *node,
+                                const std::vector<Node<V> *> &tempNodeLevels) {
+  for (size_t i = 0; i < node->forward.size(); ++i) {
+    if (tempNodeLevels.at(i)->forward.at(i) == node)
+      tempNodeLevels.at(i)->forward.at(i) = node->forward.at(i);
+  }
+  delete node;
+}
+
+template <typename V, KeyPolicy P>
+const bool SkipList<V, P>::searchNode(SearchNode auto value) {
+  // Local level counter keeps search read-only, so concurrent searches are
+  // safe under a shared lock
   Node<V> *searchNode = head;
-  for (level = maxLevel - 1; level >= 0; --level) {
-    while (searchNode->forward.at(level)->value < value &&
-           searchNode->forward.at(level) != nil) {
-      searchNode = searchNode->forward.at(level);
+  for (int searchLevel = maxLevel - 1; searchLevel >= 0; --searchLevel) {
+    while (searchNode->forward.at(searchLevel)->value < value &&
+           searchNode->forward.at(searchLevel) != nil) {
+      searchNode = searchNode->forward.at(searchLevel);
     }
   }
   searchNode = searchNode->forward.at(0);
@@ -356,7 +817,8 @@ const bool SkipList<V>::searchNode(SearchNode auto value) {
   return false;
 }
 
-template <typename V> int SkipList<V>::getRandomLevel() const {
+template <typename V, KeyPolicy P>
+int SkipList<V, P>::getRandomLevel() const {
   std::mt19937_64 rng;
   uint64_t timeSeed =
       std::chrono::high_resolution_clock::now().time_since_epoch().count();
@@ -1,7 +1,17 @@
 #define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "concurrentSkipQueue.h"
+#include "deterministicSkipList.h"
 #include "linkedList.h"
+#include "shardedSkipList.h"
 #include "skipList.h"
 #include <catch.hpp>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
 
 // SkipList test for integer values
 TEST_CASE("Skip List Check if all inserted") {
@@ -131,6 +141,332 @@ TEST_CASE("Skip List Insert TestClass") {
   //  REQUIRE(sList.searchNode(a) == true);
 }
 
+// SkipList test for ordered iteration
+TEST_CASE("Skip List Iterate in order") {
+  list::SkipList<int> sList;
+  REQUIRE(sList.begin() == sList.end());
+  for (int i = 99; i >= 0; --i) {
+    sList.insertNode(i);
+  }
+  int expected = 0;
+  for (int value : sList) {
+    REQUIRE(value == expected);
+    expected++;
+  }
+  REQUIRE(expected == 100);
+}
+
+// SkipList test for CountedKeys policy, duplicates are counted in Node
+TEST_CASE("Skip List Counted duplicates") {
+  list::SkipList<int, list::CountedKeys> sList;
+  for (int i = 0; i < 100; ++i) {
+    REQUIRE(sList.insertNode(i % 10) == true);
+  }
+  REQUIRE(sList.count(3) == 10);
+  REQUIRE(sList.count(10) == 0);
+  REQUIRE(sList.searchNode(3) == true);
+
+  // Range and iteration are per distinct key value, multiplicity is given
+  // only by count
+  auto range = sList.equalRange(3);
+  REQUIRE(std::distance(range.first, range.second) == 1);
+  REQUIRE(*range.first == 3);
+  REQUIRE(*range.second == 4);
+  REQUIRE(std::distance(sList.begin(), sList.end()) == 10);
+  range = sList.equalRange(10);
+  REQUIRE(range.first == range.second);
+
+  REQUIRE(sList.eraseOne(3) == true);
+  REQUIRE(sList.count(3) == 9);
+  REQUIRE(sList.eraseAll(3) == 9);
+  REQUIRE(sList.count(3) == 0);
+  REQUIRE(sList.eraseOne(3) == false);
+  REQUIRE(sList.eraseAll(3) == 0);
+  REQUIRE(sList.eraseNode(4) == true);
+  REQUIRE(sList.searchNode(4) == false);
+
+  int expected = 0;
+  for (int value : sList) {
+    if (expected == 3)
+      expected = 5;
+    REQUIRE(value == expected);
+    expected++;
+  }
+  REQUIRE(expected == 10);
+}
+
+// SkipList test for count and erase functions with UniqueKeys policy
+TEST_CASE("Skip List Unique count and erase") {
+  list::SkipList<int> sList;
+  REQUIRE(sList.insertNode(7) == true);
+  REQUIRE(sList.insertNode(7) == false);
+  REQUIRE(sList.count(7) == 1);
+  REQUIRE(sList.eraseOne(7) == true);
+  REQUIRE(sList.count(7) == 0);
+  REQUIRE(sList.insertNode(7) == true);
+  REQUIRE(sList.eraseAll(7) == 1);
+  REQUIRE(sList.begin() == sList.end());
+}
+
+// SkipList test for popping Nodes from front
+TEST_CASE("Skip List Pop front") {
+  list::SkipList<int, list::CountedKeys> sList;
+  REQUIRE(sList.empty() == true);
+  REQUIRE(sList.popFront() == false);
+  for (int i = 99; i >= 0; --i) {
+    sList.insertNode(i);
+  }
+  sList.insertNode(0);
+  REQUIRE(sList.empty() == false);
+  REQUIRE(sList.front() == 0);
+  REQUIRE(sList.popFront() == true);
+  REQUIRE(sList.front() == 0);
+  REQUIRE(sList.popFront() == true);
+  REQUIRE(sList.front() == 1);
+
+  std::vector<int> expired;
+  REQUIRE(sList.popFrontUntil(10, [&expired](int value) {
+    expired.push_back(value);
+  }) == 9);
+  REQUIRE(expired.size() == 9);
+  REQUIRE(expired.front() == 1);
+  REQUIRE(expired.back() == 9);
+  REQUIRE(sList.front() == 10);
+  REQUIRE(sList.searchNode(9) == false);
+  REQUIRE(sList.searchNode(10) == true);
+  REQUIRE(sList.popFrontUntil(10) == 0);
+  REQUIRE(sList.popFrontUntil(1000) == 90);
+  REQUIRE(sList.empty() == true);
+  REQUIRE(sList.insertNode(5) == true);
+  REQUIRE(sList.front() == 5);
+}
+
+// ConcurrentSkipQueue test for multiple consumers popping from the queue
+TEST_CASE("Concurrent Skip Queue Multiple consumers") {
+  list::ConcurrentSkipQueue<int> queue;
+  for (int i = 0; i < 4000; ++i) {
+    REQUIRE(queue.push(i % 2000) == true);
+  }
+  REQUIRE(queue.popFrontUntil(10).size() == 20);
+
+  std::vector<std::vector<int>> popped(4);
+  std::vector<std::thread> consumers;
+  for (int t = 0; t < 4; ++t) {
+    consumers.emplace_back([&queue, &popped, t]() {
+      int value;
+      while (queue.tryPopFront(value)) {
+        popped.at(t).push_back(value);
+      }
+    });
+  }
+  for (auto &consumer : consumers) {
+    consumer.join();
+  }
+
+  REQUIRE(queue.empty() == true);
+  std::size_t total = 0;
+  for (const auto &values : popped) {
+    total += values.size();
+    for (size_t i = 1; i < values.size(); ++i) {
+      REQUIRE(values.at(i - 1) <= values.at(i));
+    }
+  }
+  REQUIRE(total == 3980);
+}
+
+// SkipList test for interleaved lookup of many key values
+TEST_CASE("Skip List Lookup many") {
+  list::SkipList<int> sList;
+  for (int i = 0; i < 1000; i += 2) {
+    sList.insertNode(i);
+  }
+  std::vector<int> values;
+  for (int i = 1000; i >= -10; --i) {
+    values.push_back(i);
+  }
+
+  for (std::size_t inFlight : {0, 1, 3, 16, 2000}) {
+    std::vector<bool> found = sList.lookupMany(values, inFlight);
+    REQUIRE(found.size() == values.size());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      REQUIRE(found.at(i) == (values.at(i) >= 0 && values.at(i) < 1000 &&
+                              values.at(i) % 2 == 0));
+    }
+  }
+  REQUIRE(sList.lookupMany({}).empty());
+}
+
+// ShardedSkipList test for insert, search, erase and batch operations
+TEST_CASE("Sharded Skip List Insert, search and erase") {
+  list::ShardedSkipList<int, 4> sList;
+  for (int i = 0; i < 1000; ++i) {
+    REQUIRE(sList.insertNode(i) == true);
+  }
+  REQUIRE(sList.insertNode(222) == false);
+  REQUIRE(sList.searchNode(222) == true);
+  REQUIRE(sList.searchNode(2100) == false);
+  REQUIRE(sList.eraseNode(333) == true);
+  REQUIRE(sList.eraseNode(333) == false);
+  REQUIRE(sList.searchNode(333) == false);
+
+  std::vector<int> batch{333, 1000, 1001, 5};
+  REQUIRE(sList.insertBatch(batch) == 3);
+  REQUIRE(sList.searchNode(1001) == true);
+  REQUIRE(sList.eraseBatch(batch) == 4);
+  REQUIRE(sList.searchNode(5) == false);
+}
+
+// ShardedSkipList test for ordered iteration over shards written from
+// multiple threads
+TEST_CASE("Sharded Skip List Concurrent insert and ordered iteration") {
+  list::ShardedSkipList<int, 8> sList;
+  std::vector<std::thread> writers;
+  for (int t = 0; t < 4; ++t) {
+    writers.emplace_back([&sList, t]() {
+      for (int i = t; i < 4000; i += 4) {
+        sList.insertNode(i);
+      }
+    });
+  }
+  for (auto &writer : writers) {
+    writer.join();
+  }
+
+  int expected = 0;
+  sList.forEach([&expected](int value) {
+    REQUIRE(value == expected);
+    expected++;
+  });
+  REQUIRE(expected == 4000);
+}
+
+// ShardedSkipList test for user defined partitioner, which maps key ranges to
+// shards, and for concurrent readers using count
+TEST_CASE("Sharded Skip List Range partitioner") {
+  struct RangePartitioner {
+    std::size_t operator()(int value) const { return value / 1000; }
+  };
+  list::ShardedSkipList<int, 4, RangePartitioner> sList;
+  for (int i = 3999; i >= 0; --i) {
+    REQUIRE(sList.insertNode(i) == true);
+  }
+
+  std::vector<std::size_t> found(4, 0);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&sList, &found, t]() {
+      for (int i = 0; i < 4000; ++i) {
+        found.at(t) += sList.count(i);
+      }
+    });
+  }
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  for (std::size_t total : found) {
+    REQUIRE(total == 4000);
+  }
+  REQUIRE(sList.count(4000) == 0);
+
+  REQUIRE(sList.eraseBatch({0, 1000, 2000, 3000}) == 4);
+  int expected = 1;
+  sList.forEach([&expected](int value) {
+    if (value % 1000 == 1 && value != 1)
+      expected++;
+    REQUIRE(value == expected);
+    expected++;
+  });
+  REQUIRE(expected == 4000);
+}
+
+// DeterministicSkipList test for integer values
+TEST_CASE("Deterministic Skip List Insert, search and erase") {
+  list::DeterministicSkipList<int> dList;
+  for (int i = 0; i < 1000; ++i) {
+    REQUIRE(dList.insertNode(i) == true);
+  }
+  // 222 is already inserted, no duplicates
+  REQUIRE(dList.insertNode(222) == false);
+  for (int i = 0; i < 1000; ++i) {
+    REQUIRE(dList.searchNode(i) == true);
+  }
+  REQUIRE(dList.searchNode(2100) == false);
+  REQUIRE(dList.eraseNode(1) == true);
+  REQUIRE(dList.eraseNode(2) == true);
+  REQUIRE(dList.eraseNode(2222) == false);
+  REQUIRE(dList.eraseNode(-20) == false);
+  REQUIRE(dList.eraseNode(333) == true);
+  REQUIRE(dList.searchNode(333) == false);
+  REQUIRE(dList.count(333) == 0);
+  REQUIRE(dList.count(334) == 1);
+
+  // Erase every other key value, including Nodes of higher levels
+  for (int i = 0; i < 1000; i += 2) {
+    dList.eraseNode(i);
+  }
+  int expected = 3;
+  for (int value : dList) {
+    if (expected == 333)
+      expected += 2;
+    REQUIRE(value == expected);
+    expected += 2;
+  }
+  REQUIRE(expected == 1001);
+}
+
+// DeterministicSkipList test for popping Nodes from front
+TEST_CASE("Deterministic Skip List Pop front") {
+  list::DeterministicSkipList<int> dList;
+  REQUIRE(dList.empty() == true);
+  REQUIRE(dList.popFront() == false);
+  for (int i = 99; i >= 0; --i) {
+    dList.insertNode(i);
+  }
+  REQUIRE(dList.front() == 0);
+  REQUIRE(dList.popFront() == true);
+  REQUIRE(dList.front() == 1);
+  REQUIRE(dList.popFrontUntil(50) == 49);
+  REQUIRE(dList.front() == 50);
+  REQUIRE(dList.searchNode(49) == false);
+  REQUIRE(dList.popFrontUntil(1000) == 50);
+  REQUIRE(dList.empty() == true);
+  REQUIRE(dList.insertNode(5) == true);
+  REQUIRE(dList.front() == 5);
+}
+
+// DeterministicSkipList test for CountedKeys policy, duplicates are counted in
+// Node
+TEST_CASE("Deterministic Skip List Counted duplicates") {
+  list::DeterministicSkipList<int, list::CountedKeys> dList;
+  for (int i = 0; i < 100; ++i) {
+    REQUIRE(dList.insertNode(i % 10) == true);
+  }
+  REQUIRE(dList.count(3) == 10);
+  REQUIRE(dList.count(10) == 0);
+
+  auto range = dList.equalRange(3);
+  REQUIRE(std::distance(range.first, range.second) == 1);
+  REQUIRE(*range.first == 3);
+  range = dList.equalRange(10);
+  REQUIRE(range.first == range.second);
+
+  REQUIRE(dList.eraseOne(3) == true);
+  REQUIRE(dList.count(3) == 9);
+  REQUIRE(dList.eraseAll(3) == 9);
+  REQUIRE(dList.eraseOne(3) == false);
+  REQUIRE(dList.eraseAll(3) == 0);
+
+  REQUIRE(dList.popFront() == true);
+  REQUIRE(dList.count(0) == 9);
+  std::vector<int> expired;
+  REQUIRE(dList.popFrontUntil(2, [&expired](int value) {
+    expired.push_back(value);
+  }) == 19);
+  REQUIRE(expired.size() == 19);
+  REQUIRE(expired.back() == 1);
+  REQUIRE(dList.front() == 2);
+}
+
 TEST_CASE("Insert into linked list, search and erase nodes") {
   list::LinkedList<int> lList;
   for (int i = 0; i < 1000; ++i) {
@@ -174,6 +510,179 @@ TEST_CASE("Benchmark - insert of elements in linked and skip list ") {
   };
 }
 
+// SkipList behind one mutex and ShardedSkipList benchmark comparison for insert
+// of elements from 4 threads
+TEST_CASE("Benchmark - concurrent insert in locked and sharded skip list ") {
+  BENCHMARK("Insert 4000 elements from 4 threads in locked skip list") {
+    list::SkipList<int> sList;
+    std::mutex sListMutex;
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+      writers.emplace_back([&sList, &sListMutex, t]() {
+        for (int i = t; i < 4000; i += 4) {
+          std::lock_guard lock(sListMutex);
+          sList.insertNode(i);
+        }
+      });
+    }
+    for (auto &writer : writers) {
+      writer.join();
+    }
+  };
+
+  BENCHMARK("Insert 4000 elements from 4 threads in sharded skip list") {
+    list::ShardedSkipList<int, 16> shardedList;
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+      writers.emplace_back([&shardedList, t]() {
+        for (int i = t; i < 4000; i += 4) {
+          shardedList.insertNode(i);
+        }
+      });
+    }
+    for (auto &writer : writers) {
+      writer.join();
+    }
+  };
+}
+
+// SkipList benchmark comparison for removal of the lowest key value using
+// eraseNode and popFront
+TEST_CASE("Benchmark - erase and pop of the lowest element in skip list ") {
+  BENCHMARK_ADVANCED("Erase the lowest element in skip list")
+  (Catch::Benchmark::Chronometer meter) {
+    list::SkipList<int> sList;
+    for (int i = 0; i < meter.runs(); ++i) {
+      sList.insertNode(i);
+    }
+    meter.measure([&sList](int i) { return sList.eraseNode(i); });
+  };
+
+  BENCHMARK_ADVANCED("Pop the lowest element in skip list")
+  (Catch::Benchmark::Chronometer meter) {
+    list::SkipList<int> sList;
+    for (int i = 0; i < meter.runs(); ++i) {
+      sList.insertNode(i);
+    }
+    meter.measure([&sList] { return sList.popFront(); });
+  };
+}
+
+// Times operation for each value with steady_clock, prints p50, p99, p99.9,
+// p99.99 and max latency in nanoseconds and returns sum of operation results
+template <typename F>
+std::size_t printLatencyPercentiles(const std::string &name,
+                                    const std::vector<int> &values,
+                                    F operation) {
+  std::vector<long long> latencies;
+  latencies.reserve(values.size());
+  std::size_t result = 0;
+  for (int value : values) {
+    auto start = std::chrono::steady_clock::now();
+    result += operation(value);
+    auto stop = std::chrono::steady_clock::now();
+    latencies.push_back(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+            .count());
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](double p) {
+    std::size_t index = static_cast<std::size_t>(p * latencies.size());
+    return latencies.at(std::min(index, latencies.size() - 1));
+  };
+  std::cout << name << ": p50 " << percentile(0.5) << " ns, p99 "
+            << percentile(0.99) << " ns, p99.9 " << percentile(0.999)
+            << " ns, p99.99 " << percentile(0.9999) << " ns, max "
+            << latencies.back() << " ns" << std::endl;
+  return result;
+}
+
+// SkipList and DeterministicSkipList tail latency comparison for insert,
+// lookup and erase of 100000 elements in random order. Every operation is
+// timed separately, so unlucky Node levels of SkipList show in the upper
+// percentiles instead of being averaged away. Insert latency of SkipList
+// includes getRandomLevel, which seeds new random number generator on every
+// call, so only lookup and erase compare the two Node level schemes
+TEST_CASE("Benchmark - tail latency of randomized and deterministic skip list",
+          "[!benchmark]") {
+  constexpr int size = 100000;
+  std::vector<int> values(size);
+  std::iota(values.begin(), values.end(), 0);
+  std::mt19937 rng(2020);
+
+  list::SkipList<int> sList;
+  list::DeterministicSkipList<int> dList;
+
+  std::shuffle(values.begin(), values.end(), rng);
+  REQUIRE(printLatencyPercentiles(
+              "Insert in skip list, includes getRandomLevel", values,
+              [&sList](int value) { return sList.insertNode(value); }) ==
+          size);
+  REQUIRE(printLatencyPercentiles(
+              "Insert in deterministic skip list", values,
+              [&dList](int value) { return dList.insertNode(value); }) ==
+          size);
+
+  std::shuffle(values.begin(), values.end(), rng);
+  REQUIRE(printLatencyPercentiles(
+              "Lookup in skip list", values,
+              [&sList](int value) { return sList.count(value); }) == size);
+  REQUIRE(printLatencyPercentiles(
+              "Lookup in deterministic skip list", values,
+              [&dList](int value) { return dList.count(value); }) == size);
+
+  std::shuffle(values.begin(), values.end(), rng);
+  REQUIRE(printLatencyPercentiles(
+              "Erase in skip list", values,
+              [&sList](int value) { return sList.eraseNode(value); }) ==
+          size);
+  REQUIRE(printLatencyPercentiles(
+              "Erase in deterministic skip list", values,
+              [&dList](int value) { return dList.eraseNode(value); }) ==
+          size);
+}
+
+// SkipList benchmark comparison for sequential and interleaved lookup of 10000
+// random elements in skip list of 2^20 elements, which is much larger than
+// cache. Sequential lookups use count, which searches like searchNode without
+// printing found values. Building the list takes long, so the test case is
+// hidden and runs only when selected, e.g. ./tests "[!benchmark]"
+TEST_CASE("Benchmark - sequential and interleaved lookup in skip list ",
+          "[!benchmark]") {
+  constexpr int size = 1 << 20;
+  list::SkipList<int> sList;
+  for (int i = 0; i < size; ++i) {
+    sList.insertNode(i);
+  }
+
+  std::mt19937 rng(2020);
+  std::uniform_int_distribution<int> dist(0, size - 1);
+  std::vector<int> values(10000);
+  std::generate(values.begin(), values.end(), [&]() { return dist(rng); });
+
+  BENCHMARK("Sequential lookup of 10000 elements in skip list") {
+    std::size_t found = 0;
+    for (int value : values) {
+      found += sList.count(value);
+    }
+    return found;
+  };
+
+  BENCHMARK("Interleaved lookup of 10000 elements in skip list, 1 in flight") {
+    return sList.lookupMany(values, 1);
+  };
+
+  BENCHMARK("Interleaved lookup of 10000 elements in skip list, 8 in flight") {
+    return sList.lookupMany(values, 8);
+  };
+
+  BENCHMARK("Interleaved lookup of 10000 elements in skip list, 16 in "
+            "flight") {
+    return sList.lookupMany(values, 16);
+  };
+}
+
 // SkipList and LinkedList benchmark comparison for insert search and erase of
 // element in lists of 100000 elements
 TEST_CASE("Benchmark - search and erase of element in linked and skip list ") {